@@ -5,10 +5,14 @@
 
 #include "cubic_gadget/test.cpp"
 #include "generic_cubic_gadget/test.cpp"
+#include "secret_root_gadget/test.cpp"
+#include "merkle_membership_gadget/test.cpp"
 
 int main() {
     run_cubic_gadget_tests();
     run_generic_cubic_gadget_tests();
+    run_secret_root_gadget_tests();
+    run_merkle_membership_gadget_tests();
 
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,203 @@
+/*
+ * Benchmark of the two set membership approaches implemented in this repo, as the size of the set grows:
+ * - "secret_root_gadget": knowledge of a root of the polynomial (R1 - x) * ... * (Rn - x), where the set is public
+ * - "merkle_membership_gadget": knowledge of a leaf of a Merkle tree, where only the root is public
+ *
+ * For each size of set (2**k, for k = 1, ..., max_log_size), we print:
+ * - The number of constraints of each circuit
+ * - The size of the primary input of each circuit
+ * - The time spent by the prover for each circuit (the generator is not timed)
+ * - The average time of an incremental update of the Merkle tree out of the circuit (add_leaf)
+ *
+ * Note: The secret_root_gadget has one primary input per element of the set, so it is only benchmarked
+ * for sets of at most 2**MAX_SECRET_ROOT_LOG_SIZE elements ("-" is printed for larger sets).
+ * Note: The circuit of the merkle_membership_gadget only depends on the depth of the tree, and the cost of
+ * add_leaf only depends on the depth of the tree too. Since the host-side SHA256 (get_hash) is slow, only the
+ * first 2**MAX_FILLED_LOG_SIZE leaves of the tree are filled (the number of filled leaves is printed).
+ *
+ * Usage: ./merkle_membership_benchmark [max_log_size] (default: 10, between 1 and 32)
+ **/
+
+#include <algorithm>
+#include <chrono>
+#include <cerrno>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+
+#include <libff/algebra/curves/alt_bn128/alt_bn128_pp.hpp>
+#include <libff/common/profiling.hpp>
+#include <libsnark/gadgetlib1/gadgets/hashes/sha256/sha256_gadget.hpp>
+#include <libsnark/zk_proof_systems/ppzksnark/r1cs_ppzksnark/r1cs_ppzksnark.hpp>
+
+#include "secret_root_gadget/secret_root_gadget.cpp"
+#include "merkle_membership_gadget.cpp"
+#include "merkle_tree_builder.cpp"
+
+const size_t DEFAULT_LOG_SIZE = 10;
+const size_t MAX_LOG_SIZE = 32;
+const size_t MAX_SECRET_ROOT_LOG_SIZE = 16;
+const size_t MAX_FILLED_LOG_SIZE = 10;
+const int COLUMN_WIDTH = 16;
+
+struct benchmark_result {
+    size_t num_constraints;
+    size_t num_inputs;
+    double prover_seconds;
+};
+
+template<typename ppT>
+double time_prover(const libsnark::protoboard<libff::Fr<ppT>> &pb) {
+    auto keypair = libsnark::r1cs_ppzksnark_generator<ppT>(pb.get_constraint_system());
+
+    auto start = std::chrono::steady_clock::now();
+    auto proof = libsnark::r1cs_ppzksnark_prover<ppT>(keypair.pk, pb.primary_input(), pb.auxiliary_input());
+    auto end = std::chrono::steady_clock::now();
+
+    if (!libsnark::r1cs_ppzksnark_verifier_strong_IC<ppT>(keypair.vk, pb.primary_input(), proof)) {
+        throw std::runtime_error("The proof generated by the benchmark is not valid");
+    }
+
+    return std::chrono::duration<double>(end - start).count();
+}
+
+template<typename ppT>
+benchmark_result benchmark_secret_root_gadget(const size_t set_size) {
+    typedef libff::Fr<ppT> FieldT;
+    libsnark::protoboard<FieldT> pb;
+
+    // The set S = {0, 1, ..., set_size - 1} is the primary input
+    libsnark::pb_variable_array<FieldT> roots;
+    roots.allocate(pb, set_size, "roots");
+    for (size_t i = 0; i < set_size; ++i) {
+        pb.val(roots[i]) = FieldT(i);
+    }
+
+    libsnark::pb_variable<FieldT> sol_x;
+    sol_x.allocate(pb, "sol_x");
+    pb.val(sol_x) = FieldT(set_size / 2);
+
+    pb.set_input_sizes(set_size);
+
+    secret_root_gadget<FieldT> gadget(pb, roots, sol_x);
+    gadget.generate_r1cs_constraints();
+    gadget.generate_r1cs_witness();
+    if (!pb.is_satisfied()) {
+        throw std::runtime_error("The witness of the secret_root_gadget is not valid");
+    }
+
+    return benchmark_result{pb.num_constraints(), pb.num_inputs(), time_prover<ppT>(pb)};
+}
+
+template<typename ppT>
+benchmark_result benchmark_merkle_membership_gadget(
+    const size_t set_size,
+    size_t &num_filled_leaves,
+    double &add_leaf_milliseconds
+) {
+    typedef libff::Fr<ppT> FieldT;
+    typedef libsnark::sha256_two_to_one_hash_gadget<FieldT> HashT;
+
+    // The first num_filled_leaves members of the set S = {1, 2, ..., set_size} are committed in the tree
+    // (the leaves are added one by one, and the average time of an add_leaf is reported)
+    // Note: 0 is not a valid member, as it is the value of the empty leaves
+    num_filled_leaves = std::min(set_size, 1ul << MAX_FILLED_LOG_SIZE);
+    merkle_tree_builder<HashT> tree(merkle_tree_builder<HashT>::depth_for_set_size(set_size));
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 1; i <= num_filled_leaves; ++i) {
+        tree.add_leaf(libff::int_list_to_bits({i}, 64));
+    }
+    auto end = std::chrono::steady_clock::now();
+    add_leaf_milliseconds = std::chrono::duration<double, std::milli>(end - start).count() / num_filled_leaves;
+
+    libsnark::protoboard<FieldT> pb;
+    libsnark::pb_variable_array<FieldT> packed_root;
+    packed_root.allocate(pb, merkle_membership_gadget<FieldT, HashT>::packed_root_size(), "packed_root");
+    pb.set_input_sizes(packed_root.size());
+
+    const size_t address = num_filled_leaves / 2;
+    merkle_membership_gadget<FieldT, HashT> gadget(pb, tree.tree_depth, packed_root);
+    gadget.generate_r1cs_constraints();
+    gadget.generate_r1cs_witness(address, tree.get_leaf(address), tree.get_path(address), tree.get_root());
+    if (!pb.is_satisfied()) {
+        throw std::runtime_error("The witness of the merkle_membership_gadget is not valid");
+    }
+
+    return benchmark_result{pb.num_constraints(), pb.num_inputs(), time_prover<ppT>(pb)};
+}
+
+// Parses the max_log_size argument, returns false if it is not an integer between 1 and MAX_LOG_SIZE
+bool parse_max_log_size(const char *arg, size_t &max_log_size) {
+    char *end = nullptr;
+    errno = 0;
+    const unsigned long value = std::strtoul(arg, &end, 10);
+    if (errno != 0 || end == arg || *end != '\0' || arg[0] == '-') {
+        return false;
+    }
+    if (value < 1 || value > MAX_LOG_SIZE) {
+        return false;
+    }
+
+    max_log_size = value;
+    return true;
+}
+
+int main(int argc, char *argv[]) {
+    size_t max_log_size = DEFAULT_LOG_SIZE;
+    if (argc > 2 || (argc == 2 && !parse_max_log_size(argv[1], max_log_size))) {
+        std::cerr << "Usage: " << argv[0] << " [max_log_size] (default: " << DEFAULT_LOG_SIZE
+                  << ", between 1 and " << MAX_LOG_SIZE << ")" << std::endl;
+        return 1;
+    }
+
+    typedef libff::alt_bn128_pp ppT;
+    ppT::init_public_params();
+
+    // Only print the results of the benchmark
+    libff::inhibit_profiling_info = true;
+    libff::inhibit_profiling_counters = true;
+
+    std::cout << std::setw(COLUMN_WIDTH) << "set_size"
+              << std::setw(COLUMN_WIDTH) << "filled_leaves"
+              << std::setw(COLUMN_WIDTH) << "root_constr"
+              << std::setw(COLUMN_WIDTH) << "root_inputs"
+              << std::setw(COLUMN_WIDTH) << "root_prove_s"
+              << std::setw(COLUMN_WIDTH) << "merkle_constr"
+              << std::setw(COLUMN_WIDTH) << "merkle_inputs"
+              << std::setw(COLUMN_WIDTH) << "merkle_prove_s"
+              << std::setw(COLUMN_WIDTH) << "add_leaf_ms"
+              << std::endl;
+
+    for (size_t log_size = 1; log_size <= max_log_size; ++log_size) {
+        const size_t set_size = 1ul << log_size;
+        size_t num_filled_leaves = 0;
+        double add_leaf_milliseconds = 0;
+
+        benchmark_result merkle_result = benchmark_merkle_membership_gadget<ppT>(
+            set_size,
+            num_filled_leaves,
+            add_leaf_milliseconds
+        );
+
+        std::cout << std::setw(COLUMN_WIDTH) << set_size
+                  << std::setw(COLUMN_WIDTH) << num_filled_leaves;
+        if (log_size <= MAX_SECRET_ROOT_LOG_SIZE) {
+            benchmark_result root_result = benchmark_secret_root_gadget<ppT>(set_size);
+            std::cout << std::setw(COLUMN_WIDTH) << root_result.num_constraints
+                      << std::setw(COLUMN_WIDTH) << root_result.num_inputs
+                      << std::setw(COLUMN_WIDTH) << root_result.prover_seconds;
+        } else {
+            std::cout << std::setw(COLUMN_WIDTH) << "-"
+                      << std::setw(COLUMN_WIDTH) << "-"
+                      << std::setw(COLUMN_WIDTH) << "-";
+        }
+        std::cout << std::setw(COLUMN_WIDTH) << merkle_result.num_constraints
+                  << std::setw(COLUMN_WIDTH) << merkle_result.num_inputs
+                  << std::setw(COLUMN_WIDTH) << merkle_result.prover_seconds
+                  << std::setw(COLUMN_WIDTH) << add_leaf_milliseconds
+                  << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,198 @@
+/*
+ * While the "secret_root_gadget" proves membership of a set by proving the knowledge of a root
+ * of the polynomial (R1 - x) * (R2 - x) * ... * (Rn - x), this approach has 2 major drawbacks:
+ * - It costs one multiplication constraint per element of the set
+ * - The whole set (the roots R1, ..., Rn) is part of the primary input
+ * Thus, both the size of the circuit and the size of the public input grow linearly with the size of the set,
+ * which makes the gadget unusable for sets with millions of members.
+ *
+ * This gadget ("merkle_membership_gadget") commits to the set with a Merkle tree, where each leaf
+ * is a member of the set. The only public input is the root of the tree, and the statement becomes:
+ * "I know a leaf, an address and an authentication path such that hashing the leaf along the path gives the root"
+ *
+ * The authentication path of a tree of depth d is made of d nodes, so the circuit only contains d hashes
+ * (+ the constraints needed to select the left/right inputs of each hash). As a consequence, the
+ * number of constraints grows with log2(size of the set), and the public input has a constant size.
+ *
+ * The circuit relies on the merkle_tree_check_read_gadget of libsnark
+ * (see: `libsnark/gadgetlib1/gadgets/merkle_tree/merkle_tree_check_read_gadget.hpp`), and is parametrized by
+ * the hash gadget HashT used to compute the nodes of the tree (eg: sha256_two_to_one_hash_gadget).
+ * The same HashT must be used to build the tree out of the circuit (see: "merkle_tree_builder").
+ *
+ * Note: The merkle_tree_check_read_gadget does not enforce the bitness of the digests computed by HashT
+ * (it generates the constraints of the hashers with enforce_bitness = false). Thus, HashT must enforce
+ * the booleanity of its output itself, as the sha256_two_to_one_hash_gadget does.
+ * HashT must also be usable without any setup, since get_hash is called by the merkle_tree_builder.
+ *
+ * Note: The empty leaves of the tree (see: "merkle_tree_builder") are equal to the zero digest.
+ * Without further constraint, anyone could prove the "membership" of the zero digest with the
+ * authentication path of an empty leaf, without knowing any member of the set.
+ * Thus, the zero digest is not a valid member, and the gadget enforces leaf != 0 by proving the knowledge
+ * of the inverse of the sum of the bits of the leaf (this sum is at most digest_len, so it cannot wrap around
+ * the modulus, and it is zero iff all the bits are zero).
+ *
+ * Note: The root is a digest (ie: a vector of bits), and is packed into field elements before being
+ * exposed as primary input. This way, the primary input is made of ceil(digest_len / FieldT::capacity())
+ * field elements (2 field elements for a 256 bits digest), instead of digest_len field elements.
+ **/
+
+#include <memory>
+#include <stdexcept>
+
+#include <libsnark/gadgetlib1/gadget.hpp>
+#include <libsnark/gadgetlib1/gadgets/basic_gadgets.hpp>
+#include <libsnark/gadgetlib1/gadgets/hashes/hash_io.hpp>
+#include <libsnark/gadgetlib1/gadgets/merkle_tree/merkle_tree_check_read_gadget.hpp>
+#include "utils.hpp"
+
+/*
+ * This gadget is made to prove the knowledge of a leaf of the Merkle tree whose root is given as primary input
+ **/
+template<typename FieldT, typename HashT>
+class merkle_membership_gadget : public libsnark::gadget<FieldT> {
+public:
+    libsnark::protoboard<FieldT> &pb;
+    const std::string annotation_prefix="";
+
+    const size_t tree_depth;
+
+    // Root of the Merkle tree packed into field elements (primary input)
+    const libsnark::pb_variable_array<FieldT> &packed_root;
+
+    // Member of the set, its address in the tree, and its authentication path (auxiliary input)
+    libsnark::pb_variable_array<FieldT> address_bits;
+    libsnark::digest_variable<FieldT> leaf;
+    libsnark::merkle_authentication_path_variable<FieldT, HashT> path;
+
+    // Inverse of the sum of the bits of the leaf (proves that the leaf is not the zero digest)
+    libsnark::pb_variable<FieldT> leaf_bits_sum_inverse;
+
+    // Bits of the root (the merkle_tree_check_read_gadget works on bits)
+    libsnark::digest_variable<FieldT> root;
+
+    std::shared_ptr<libsnark::multipacking_gadget<FieldT>> root_packer;
+    std::shared_ptr<libsnark::merkle_tree_check_read_gadget<FieldT, HashT>> check_membership;
+    merkle_membership_gadget(
+        libsnark::protoboard<FieldT> &in_pb,
+        const size_t in_tree_depth,
+        const libsnark::pb_variable_array<FieldT> &in_packed_root,
+        const std::string &in_annotation_prefix=""
+    ):
+        libsnark::gadget<FieldT>(in_pb, FMT(in_annotation_prefix, " merkle_membership")),
+        pb(in_pb),
+        annotation_prefix(in_annotation_prefix),
+        tree_depth(in_tree_depth),
+        packed_root(in_packed_root),
+        address_bits(),
+        leaf(in_pb, HashT::get_digest_len(), FMT(in_annotation_prefix, " leaf")),
+        path(in_pb, in_tree_depth, FMT(in_annotation_prefix, " path")),
+        leaf_bits_sum_inverse(),
+        root(in_pb, HashT::get_digest_len(), FMT(in_annotation_prefix, " root"))
+    {
+        if (tree_depth == 0) {
+            throw std::invalid_argument("The depth of the Merkle tree should be at least 1");
+        }
+        if (tree_depth >= sizeof(size_t) * 8) {
+            throw std::invalid_argument("The depth of the Merkle tree should be smaller than the number of bits of an address");
+        }
+        if (packed_root.size() != packed_root_size()) {
+            throw std::invalid_argument("The size of the packed root does not match the digest length of the hash");
+        }
+
+        address_bits.allocate(pb, tree_depth, FMT(this->annotation_prefix, " address_bits"));
+        leaf_bits_sum_inverse.allocate(pb, FMT(this->annotation_prefix, " leaf_bits_sum_inverse"));
+
+        root_packer.reset(new libsnark::multipacking_gadget<FieldT>(
+            pb,
+            root.bits,
+            packed_root,
+            FieldT::capacity(),
+            FMT(this->annotation_prefix, " root_packer")
+        ));
+
+        // The read is always "successful": the constant ONE (variable of index 0) is used as read_successful
+        check_membership.reset(new libsnark::merkle_tree_check_read_gadget<FieldT, HashT>(
+            pb,
+            tree_depth,
+            address_bits,
+            leaf,
+            root,
+            path,
+            libsnark::pb_variable<FieldT>(0),
+            FMT(this->annotation_prefix, " check_membership")
+        ));
+    }
+
+    // Number of field elements needed to pack the root (size of the primary input)
+    static size_t packed_root_size() {
+        return libff::div_ceil(HashT::get_digest_len(), FieldT::capacity());
+    }
+
+    // Creates all constraints on the libsnark::protoboard
+    void generate_r1cs_constraints() {
+        // The merkle_tree_check_read_gadget assumes that the address bits are boolean
+        for (size_t i = 0; i < tree_depth; ++i) {
+            libsnark::generate_boolean_r1cs_constraint<FieldT>(
+                pb,
+                address_bits[i],
+                FMT(this->annotation_prefix, " address_bits_%zu", i)
+            );
+        }
+
+        leaf.generate_r1cs_constraints();
+        path.generate_r1cs_constraints();
+
+        // (sum of the bits of the leaf) * leaf_bits_sum_inverse = 1 (the leaf is not the zero digest)
+        libsnark::linear_combination<FieldT> leaf_bits_sum;
+        for (size_t i = 0; i < leaf.bits.size(); ++i) {
+            leaf_bits_sum = leaf_bits_sum + leaf.bits[i];
+        }
+        pb.add_r1cs_constraint(
+            libsnark::r1cs_constraint<FieldT>(leaf_bits_sum, leaf_bits_sum_inverse, FieldT::one()),
+            FMT(this->annotation_prefix, " leaf_is_not_zero")
+        );
+
+        // The bitness of the root is enforced by the packer
+        root_packer->generate_r1cs_constraints(true);
+        check_membership->generate_r1cs_constraints();
+    }
+
+    // address, leaf_value and path_value are obtained from the merkle_tree_builder,
+    // root_value is the (public) root the proof is generated for
+    void generate_r1cs_witness(
+        const size_t address,
+        const libff::bit_vector &leaf_value,
+        const libsnark::merkle_authentication_path &path_value,
+        const libff::bit_vector &root_value
+    ) {
+        if (address >= (1ul << tree_depth)) {
+            throw std::out_of_range("The address is out of the Merkle tree");
+        }
+        if (path_value.size() != tree_depth) {
+            throw std::invalid_argument("The size of the authentication path does not match the depth of the tree");
+        }
+
+        // Address bits in little endian (address_bits[0] is the least significant bit)
+        libff::bit_vector address_value(tree_depth);
+        for (size_t i = 0; i < tree_depth; ++i) {
+            address_value[i] = (address >> i) & 1;
+        }
+        address_bits.fill_with_bits(pb, address_value);
+
+        leaf.generate_r1cs_witness(leaf_value);
+        path.generate_r1cs_witness(address, path_value);
+
+        // If the leaf is the zero digest, there is no inverse and the witness is not satisfied
+        FieldT leaf_bits_sum = FieldT::zero();
+        for (size_t i = 0; i < leaf.bits.size(); ++i) {
+            leaf_bits_sum += pb.val(leaf.bits[i]);
+        }
+        pb.val(leaf_bits_sum_inverse) = leaf_bits_sum.is_zero() ? FieldT::zero() : leaf_bits_sum.inverse();
+        check_membership->generate_r1cs_witness();
+
+        // The merkle_tree_check_read_gadget copies the root it computes into the root variable.
+        // We overwrite it with the expected root, so that the witness is not satisfied if the leaf is not in the tree.
+        root.generate_r1cs_witness(root_value);
+        root_packer->generate_r1cs_witness_from_bits();
+    }
+};
@@ -0,0 +1,115 @@
+/*
+ * Host-side (ie: out of the circuit) builder of the Merkle tree used by the "merkle_membership_gadget".
+ *
+ * The tree is a thin wrapper around the sparse merkle_tree of libsnark (see: `libsnark/common/data_structures/merkle_tree.hpp`)
+ * which only stores the nodes that differ from the "default" (empty) nodes.
+ * As a consequence:
+ * - Building a tree of depth d does not require to allocate the 2**d leaves
+ * - Adding/Updating a leaf only recomputes the d hashes on the path from the leaf to the root
+ *   (incremental update), instead of rehashing the whole tree
+ *
+ * The leaves are the members of the set. Each leaf is a bit vector of at most HashT::get_digest_len() bits,
+ * which is padded with zeros to the size of a digest (which is the size of the leaf_digest in the circuit).
+ * Unused leaves are equal to the zero digest, which is why the zero digest is not a valid member of the set
+ * (it is rejected here, and in the circuit by the "merkle_membership_gadget").
+ **/
+
+#include <algorithm>
+#include <stdexcept>
+
+#include <libff/common/utils.hpp>
+#include <libsnark/common/data_structures/merkle_tree.hpp>
+
+template<typename HashT>
+class merkle_tree_builder {
+public:
+    const size_t tree_depth;
+    const size_t digest_size;
+
+    merkle_tree_builder(const size_t in_tree_depth):
+        tree_depth(check_tree_depth(in_tree_depth)),
+        digest_size(HashT::get_digest_len()),
+        tree(in_tree_depth, HashT::get_digest_len()),
+        next_free_address(0)
+    {
+    }
+
+    // Depth of the smallest tree that can contain set_size leaves (ie: ceil(log2(set_size)))
+    static size_t depth_for_set_size(const size_t set_size) {
+        return (set_size <= 2) ? 1 : libff::log2(set_size);
+    }
+
+    size_t capacity() const {
+        return 1ul << tree_depth;
+    }
+
+    size_t num_leaves() const {
+        return next_free_address;
+    }
+
+    // Appends a member to the set and returns its address in the tree
+    size_t add_leaf(const libff::bit_vector &leaf_value) {
+        if (next_free_address >= capacity()) {
+            throw std::out_of_range("The Merkle tree is full");
+        }
+
+        const size_t address = next_free_address;
+        set_leaf(address, leaf_value);
+        next_free_address++;
+        return address;
+    }
+
+    // Replaces a member of the set (only the tree_depth hashes on the path to the root are recomputed)
+    // Only the leaves filled by add_leaf can be updated, so that num_leaves() is the number of members of the set
+    void update_leaf(const size_t address, const libff::bit_vector &leaf_value) {
+        if (address >= next_free_address) {
+            throw std::out_of_range("The address does not contain a member of the set");
+        }
+
+        set_leaf(address, leaf_value);
+    }
+
+    libff::bit_vector get_leaf(const size_t address) const {
+        return tree.get_value(address);
+    }
+
+    libff::bit_vector get_root() const {
+        return tree.get_root();
+    }
+
+    // Siblings of the nodes on the path from the leaf to the root (as expected by merkle_authentication_path_variable)
+    libsnark::merkle_authentication_path get_path(const size_t address) const {
+        return tree.get_path(address);
+    }
+
+private:
+    // The depth is checked before the sparse tree is built (libsnark only asserts on it)
+    static size_t check_tree_depth(const size_t in_tree_depth) {
+        if (in_tree_depth == 0) {
+            throw std::invalid_argument("The depth of the Merkle tree should be at least 1");
+        }
+        if (in_tree_depth >= sizeof(size_t) * 8) {
+            throw std::invalid_argument("The depth of the Merkle tree should be smaller than the number of bits of an address");
+        }
+        return in_tree_depth;
+    }
+
+    // Sparse tree of libsnark (only accessed through the methods above, which enforce the invariants of the set)
+    libsnark::merkle_tree<HashT> tree;
+
+    // Address of the next leaf to be used by add_leaf (ie: number of members of the set)
+    size_t next_free_address;
+
+    void set_leaf(const size_t address, const libff::bit_vector &leaf_value) {
+        if (leaf_value.size() > digest_size) {
+            throw std::invalid_argument("The leaf should not be larger than a digest");
+        }
+        if (std::find(leaf_value.begin(), leaf_value.end(), true) == leaf_value.end()) {
+            throw std::invalid_argument("The leaf should not be zero (zero is the value of the empty leaves)");
+        }
+
+        libff::bit_vector padded_leaf = leaf_value;
+        padded_leaf.resize(digest_size, false);
+        tree.set_value(address, padded_leaf);
+    }
+};
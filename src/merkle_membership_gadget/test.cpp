@@ -0,0 +1,129 @@
+#include <stdexcept>
+
+#include <libff/algebra/curves/alt_bn128/alt_bn128_pp.hpp>
+#include <libsnark/gadgetlib1/gadgets/hashes/sha256/sha256_gadget.hpp>
+#include <libsnark/zk_proof_systems/ppzksnark/r1cs_ppzksnark/r1cs_ppzksnark.hpp>
+
+#include "merkle_membership_gadget.cpp"
+#include "merkle_tree_builder.cpp"
+
+template<typename ppT>
+bool merkle_membership_gadget_test_iteration(
+        const merkle_tree_builder<libsnark::sha256_two_to_one_hash_gadget<libff::Fr<ppT>>> &tree,
+        const size_t address,
+        libff::bit_vector leaf_bits
+){
+    typedef libff::Fr<ppT> FieldT;
+    typedef libsnark::sha256_two_to_one_hash_gadget<FieldT> HashT;
+    libsnark::protoboard<FieldT> pb;
+
+    // The leaves of the tree are padded to the size of a digest (see: merkle_tree_builder)
+    leaf_bits.resize(HashT::get_digest_len(), false);
+
+    // The primary input (packed root) is allocated first on the protoboard
+    libsnark::pb_variable_array<FieldT> packed_root;
+    packed_root.allocate(pb, merkle_membership_gadget<FieldT, HashT>::packed_root_size(), "packed_root");
+
+    // Primary input: packed_root
+    // Auxiliary input: leaf, address, authentication path (allocated by the gadget)
+    pb.set_input_sizes(packed_root.size());
+
+    // Setup the tested gadget
+    merkle_membership_gadget<FieldT, HashT> tested_gadget(pb, tree.tree_depth, packed_root);
+    tested_gadget.generate_r1cs_constraints();
+    tested_gadget.generate_r1cs_witness(address, leaf_bits, tree.get_path(address), tree.get_root());
+
+    bool is_valid_witness = pb.is_satisfied();
+    if(is_valid_witness == false) {
+        return false;
+    }
+
+    // Generate keypair
+    auto keypair = libsnark::r1cs_ppzksnark_generator<ppT>(pb.get_constraint_system());
+
+    auto primary_input = pb.primary_input(); // Packed root of the tree
+    auto auxiliary_input = pb.auxiliary_input();
+
+    std::cout << "[DEBUG] Primary input: " << primary_input << std::endl;
+
+    // Generate the proof
+    auto proof = libsnark::r1cs_ppzksnark_prover<ppT>(keypair.pk, primary_input, auxiliary_input);
+
+    // Verify the proof
+    const bool proof_result = libsnark::r1cs_ppzksnark_verifier_strong_IC<ppT>(keypair.vk, primary_input, proof);
+    if(proof_result == false){
+        return false;
+    }
+
+    return true;
+}
+
+int run_merkle_membership_gadget_tests() {
+    typedef libff::alt_bn128_pp ppT;
+    typedef libff::Fr<ppT> FieldT;
+    typedef libsnark::sha256_two_to_one_hash_gadget<FieldT> HashT;
+    ppT::init_public_params();
+    bool res_test = false;
+
+    std::cout << "[Test: merkle_membership_gadget] Start tests" << std::endl;
+
+    // We build the set S = {3, 8, 35, 2071} in a tree of depth 3 (8 leaves, 4 of them are used)
+    merkle_tree_builder<HashT> tree(3);
+    tree.add_leaf({1, 1});
+    const size_t address_of_8 = tree.add_leaf({0, 0, 0, 1});
+    tree.add_leaf({1, 1, 0, 0, 0, 1});
+    const size_t address_of_2071 = tree.add_leaf({1, 1, 1, 0, 1, 0, 0, 0, 0, 0, 0, 1});
+
+    // We prove the membership of 8 (which is in S)
+    // This test SHOULD PASS
+    res_test = merkle_membership_gadget_test_iteration<ppT>(tree, address_of_8, {0, 0, 0, 1});
+    if (res_test == false) {
+        throw std::invalid_argument("The leaf is in the tree BUT the test does not pass");
+    }
+
+    // We try to prove the membership of 16 (which is not in S) with the authentication path of 8
+    // This test SHOULD NOT PASS
+    res_test = merkle_membership_gadget_test_iteration<ppT>(tree, address_of_8, {0, 0, 0, 0, 1});
+    if (res_test == true) {
+        throw std::invalid_argument("The leaf is not in the tree BUT the test pass");
+    }
+
+    // We try to prove the membership of the zero digest with the authentication path of an empty leaf (address 5)
+    // This test SHOULD NOT PASS
+    res_test = merkle_membership_gadget_test_iteration<ppT>(tree, 5, {0});
+    if (res_test == true) {
+        throw std::invalid_argument("The leaf is an empty leaf of the tree BUT the test pass");
+    }
+
+    // The zero digest cannot be added to the set
+    bool is_rejected = false;
+    try {
+        tree.add_leaf({0, 0, 0});
+    } catch (const std::invalid_argument &) {
+        is_rejected = true;
+    }
+    if (is_rejected == false) {
+        throw std::invalid_argument("The zero leaf is not a valid member BUT it has been added to the tree");
+    }
+
+    // We replace 2071 by 16 in the set (incremental update of the tree)
+    // and we prove the membership of 16 under the new root
+    // This test SHOULD PASS
+    tree.update_leaf(address_of_2071, {0, 0, 0, 0, 1});
+    res_test = merkle_membership_gadget_test_iteration<ppT>(tree, address_of_2071, {0, 0, 0, 0, 1});
+    if (res_test == false) {
+        throw std::invalid_argument("The leaf has been added to the tree BUT the test does not pass");
+    }
+
+    // 2071 has been removed from the set, so its membership cannot be proved under the new root
+    // This test SHOULD NOT PASS
+    res_test = merkle_membership_gadget_test_iteration<ppT>(tree, address_of_2071, {1, 1, 1, 0, 1, 0, 0, 0, 0, 0, 0, 1});
+    if (res_test == true) {
+        throw std::invalid_argument("The leaf has been removed from the tree BUT the test pass");
+    }
+
+    std::cout << "[Test: merkle_membership_gadget] End of tests" << std::endl;
+    std::cout << "[Test: merkle_membership_gadget] All tests PASSED" << std::endl;
+
+    return 0;
+}
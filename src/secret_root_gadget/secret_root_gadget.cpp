@@ -41,4 +41,98 @@
  * x4 = x1 * x2
  * x5 = x4 * x3
  * x6 = 0
- **/
\ No newline at end of file
+ **/
+
+#include <stdexcept>
+
+#include <libsnark/gadgetlib1/gadget.hpp>
+#include "utils.hpp"
+
+/*
+ * This gadget is made to prove the knowledge of x such that:
+ * (R1 - x) * (R2 - x) * ... * (Rn - x) = 0, where R1, ..., Rn are given as primary input
+ *
+ * Note: The subtractions are linear combinations, and thus do not cost any constraint.
+ * We only pay for the multiplications, which gives n constraints for a set of n roots
+ * (n-1 multiplications + the final constraint on the value of the product).
+ **/
+template<typename FieldT>
+class secret_root_gadget : public libsnark::gadget<FieldT> {
+public:
+    libsnark::protoboard<FieldT> &pb;
+    const std::string annotation_prefix="";
+
+    // Roots of the polynomial, ie: elements of the set S (primary input)
+    const libsnark::pb_variable_array<FieldT> &roots;
+
+    // Secret root x (auxiliary input)
+    const libsnark::pb_variable<FieldT> &sol_x;
+
+    // Partial products: products[i] = (R1 - x) * ... * (R(i+2) - x)
+    libsnark::pb_variable_array<FieldT> products;
+    secret_root_gadget(
+        libsnark::protoboard<FieldT> &in_pb,
+        const libsnark::pb_variable_array<FieldT> &in_roots,
+        const libsnark::pb_variable<FieldT> &in_sol_x,
+        const std::string &in_annotation_prefix=""
+    ):
+        libsnark::gadget<FieldT>(in_pb, FMT(in_annotation_prefix, " secret_root")),
+        pb(in_pb),
+        annotation_prefix(in_annotation_prefix),
+        roots(in_roots),
+        sol_x(in_sol_x),
+        products()
+    {
+        if (roots.size() == 0) {
+            throw std::invalid_argument("The set of roots should not be empty");
+        }
+        products.allocate(pb, roots.size() - 1, FMT(this->annotation_prefix, " products"));
+    }
+
+    // Creates all constraints on the libsnark::protoboard
+    void generate_r1cs_constraints() {
+        if (roots.size() == 1) {
+            // (R1 - x) * 1 = 0
+            pb.add_r1cs_constraint(libsnark::r1cs_constraint<FieldT>(
+                roots[0] - sol_x,
+                FieldT::one(),
+                FieldT::zero()
+            ));
+            return;
+        }
+
+        // (R1 - x) * (R2 - x) = products[0]
+        pb.add_r1cs_constraint(libsnark::r1cs_constraint<FieldT>(
+            roots[0] - sol_x,
+            roots[1] - sol_x,
+            products[0]
+        ));
+
+        // products[i-1] * (R(i+2) - x) = products[i]
+        for (size_t i = 1; i < products.size(); ++i) {
+            pb.add_r1cs_constraint(libsnark::r1cs_constraint<FieldT>(
+                products[i-1],
+                roots[i+1] - sol_x,
+                products[i]
+            ));
+        }
+
+        // products[n-2] = 0 (x is one of the roots)
+        pb.add_r1cs_constraint(libsnark::r1cs_constraint<FieldT>(
+            products[products.size() - 1],
+            FieldT::one(),
+            FieldT::zero()
+        ));
+    }
+
+    void generate_r1cs_witness() {
+        if (roots.size() == 1) {
+            return;
+        }
+
+        pb.val(products[0]) = (pb.val(roots[0]) - pb.val(sol_x)) * (pb.val(roots[1]) - pb.val(sol_x));
+        for (size_t i = 1; i < products.size(); ++i) {
+            pb.val(products[i]) = pb.val(products[i-1]) * (pb.val(roots[i+1]) - pb.val(sol_x));
+        }
+    }
+};
@@ -0,0 +1,123 @@
+#include <stdexcept>
+
+#include <libff/algebra/curves/alt_bn128/alt_bn128_pp.hpp>
+#include <libsnark/zk_proof_systems/ppzksnark/r1cs_ppzksnark/r1cs_ppzksnark.hpp>
+
+#include "secret_root_gadget.cpp"
+
+template<typename ppT>
+bool secret_root_gadget_test_iteration(
+        std::vector<libff::bit_vector> roots_bits,
+        libff::bit_vector x_bits
+){
+    typedef libff::Fr<ppT> FieldT;
+    libsnark::protoboard<FieldT> pb;
+
+    // The roots of the polynomial (ie: the elements of the set) are the primary input
+    // and need to be allocated first on the protoboard.
+    // Note: field_element_from_bits allocates variables on the protoboard, so it is only called
+    // once roots and sol_x are allocated (the bits it allocates are then part of the auxiliary input)
+    libsnark::pb_variable_array<FieldT> roots;
+    roots.allocate(pb, roots_bits.size(), "roots");
+
+    // Now we can allocate the auxiliary input to the protoboard
+    libsnark::pb_variable<FieldT> sol_x;
+    sol_x.allocate(pb, "sol_x");
+
+    std::vector<FieldT> field_roots;
+    for (size_t i = 0; i < roots_bits.size(); ++i) {
+        field_roots.push_back(field_element_from_bits(pb, roots_bits[i]));
+    }
+    roots.fill_with_field_elements(pb, field_roots);
+    pb.val(sol_x) = field_element_from_bits(pb, x_bits);
+
+    // Primary input: field_roots
+    // Auxiliary input: sol_x
+    pb.set_input_sizes(field_roots.size());
+
+    // Make sure that the proof is bound to the set (the primary input is the set of roots)
+    if (pb.primary_input() != field_roots) {
+        throw std::invalid_argument("The primary input is not the set of roots");
+    }
+
+    // Setup the tested gadget
+    secret_root_gadget<FieldT> tested_gadget(pb, roots, sol_x);
+    tested_gadget.generate_r1cs_constraints();
+    tested_gadget.generate_r1cs_witness();
+
+    bool is_valid_witness = pb.is_satisfied();
+    if(is_valid_witness == false) {
+        return false;
+    }
+
+    // Generate keypair
+    auto keypair = libsnark::r1cs_ppzksnark_generator<ppT>(pb.get_constraint_system());
+
+    auto primary_input = pb.primary_input(); // Roots of the polynomial
+    auto auxiliary_input = pb.auxiliary_input();
+
+    std::cout << "[DEBUG] Primary input: " << primary_input << std::endl;
+    std::cout << "[DEBUG] Auxiliary input: " << auxiliary_input << std::endl;
+
+    // Generate the proof
+    auto proof = libsnark::r1cs_ppzksnark_prover<ppT>(keypair.pk, primary_input, auxiliary_input);
+
+    // Verify the proof
+    const bool proof_result = libsnark::r1cs_ppzksnark_verifier_strong_IC<ppT>(keypair.vk, primary_input, proof);
+    if(proof_result == false){
+        return false;
+    }
+
+    return true;
+}
+
+int run_secret_root_gadget_tests() {
+    typedef libff::alt_bn128_pp ppT;
+    ppT::init_public_params();
+    bool res_test = false;
+
+    std::cout << "[Test: secret_root_gadget] Start tests" << std::endl;
+
+    // We encode the set S = {3, 8, 35}
+    // with sol_x = 8
+    // This test SHOULD PASS
+    std::vector<libff::bit_vector> roots_bits = {{1, 1}, {0, 0, 0, 1}, {1, 1, 0, 0, 0, 1}};
+    libff::bit_vector sol_x_bits = {0, 0, 0, 1};
+    res_test = secret_root_gadget_test_iteration<ppT>(roots_bits, sol_x_bits);
+    if (res_test == false) {
+        throw std::invalid_argument("The argument is in the set BUT the test does not pass");
+    }
+
+    // We encode the set S = {3, 8, 35}
+    // with sol_x = 16
+    // This test SHOULD NOT PASS
+    sol_x_bits = {0, 0, 0, 0, 1};
+    res_test = secret_root_gadget_test_iteration<ppT>(roots_bits, sol_x_bits);
+    if (res_test == true) {
+        throw std::invalid_argument("The argument is not in the set BUT the test pass");
+    }
+
+    // We encode the set S = {35} (single root)
+    // with sol_x = 35
+    // This test SHOULD PASS
+    roots_bits = {{1, 1, 0, 0, 0, 1}};
+    sol_x_bits = {1, 1, 0, 0, 0, 1};
+    res_test = secret_root_gadget_test_iteration<ppT>(roots_bits, sol_x_bits);
+    if (res_test == false) {
+        throw std::invalid_argument("The argument is in the set BUT the test does not pass");
+    }
+
+    // We encode the set S = {35} (single root)
+    // with sol_x = 3
+    // This test SHOULD NOT PASS
+    sol_x_bits = {1, 1};
+    res_test = secret_root_gadget_test_iteration<ppT>(roots_bits, sol_x_bits);
+    if (res_test == true) {
+        throw std::invalid_argument("The argument is not in the set BUT the test pass");
+    }
+
+    std::cout << "[Test: secret_root_gadget] End of tests" << std::endl;
+    std::cout << "[Test: secret_root_gadget] All tests PASSED" << std::endl;
+
+    return 0;
+}